@@ -21,12 +21,63 @@
 
 #include "raylib.h"
 #include <math.h>        // Used for sinf()
+#include <stdio.h>       // Used for FILE, fopen(), printf(), snprintf()
+#include <stdlib.h>      // Used for malloc(), atoi(), srand()
+#include <string.h>      // Used for strcmp(), memcpy(), memset()
+#include <time.h>        // Used for clock()
 
 #if defined(PLATFORM_WEB)
     #include <emscripten/emscripten.h>
 #endif
 
-#define MAX_ENEMIES 10
+// Capture mode and GPU timing need desktop OpenGL 3.3 (pixel buffer objects, timer queries)
+// Idle throttling needs GLFW key events, so key taps shorter than a throttled frame are not lost
+// NOTE: They use raylib source tree headers (rlgl.h, external/glad.h, external/stb_image_write.h, external/glfw)
+// and raylib internal GL loader and GLFW symbols, Makefile defines SUPPORT_RAYLIB_INTERNALS when found in RAYLIB_PATH
+#if defined(PLATFORM_DESKTOP) && defined(SUPPORT_RAYLIB_INTERNALS)
+    #define SUPPORT_CAPTURE_MODE
+    #define SUPPORT_GPU_TIMING
+    #define SUPPORT_IDLE_THROTTLE
+#endif
+
+#if defined(SUPPORT_CAPTURE_MODE) || defined(SUPPORT_GPU_TIMING)
+    #include "rlgl.h"    // Required for: rlglDraw()
+    #include "glad.h"    // OpenGL functions, already loaded by raylib rlgl module
+#endif
+
+#if defined(SUPPORT_CAPTURE_MODE)
+    #include <pthread.h>
+
+    // PNG encoder, compiled privately so writer threads never touch raylib static buffers
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wunused-function"
+    #define STB_IMAGE_WRITE_STATIC
+    #define STB_IMAGE_WRITE_IMPLEMENTATION
+    #include "stb_image_write.h"
+    #pragma GCC diagnostic pop
+#endif
+
+#if defined(SUPPORT_IDLE_THROTTLE)
+    #define GLFW_INCLUDE_NONE
+    #include "glfw/include/GLFW/glfw3.h"    // Required for: glfwSetKeyCallback(), GLFW already initialized by raylib
+#endif
+
+#define MIN_RAILS                  2    // Respawn logic keeps consecutive enemies on different rails
+#define MAX_RAILS                 64
+#define ENEMIES_PER_RAIL           2
+#define MAX_ENEMIES     (MAX_RAILS*ENEMIES_PER_RAIL)
+
+#define MAX_SCRIPT_EVENTS       1024    // Max key presses in a capture input script
+#define CAPTURE_PBO_COUNT          3    // Pixel buffer objects ring, readback is mapped CAPTURE_PBO_COUNT - 1 frames later
+#define CAPTURE_POOL_SIZE         16    // Frames buffered between render thread and writer threads
+#define CAPTURE_WRITER_THREADS     4    // Threads encoding frames to disk
+#define CAPTURE_DEFAULT_FRAMES   600    // Frames captured in headless mode when --frames is not given
+
+#define IDLE_TIMEOUT_FRAMES      300    // Frames without input before idle screens tick slower
+#define IDLE_REDRAW_FPS           15    // Idle screens target fps once throttled
+#define IDLE_REDRAW_STEP (60/IDLE_REDRAW_FPS)   // Logic frames advanced per throttled frame, keeps animations pace
+#define GPU_QUERY_COUNT            4    // GPU timer queries ring, results read some frames later
+#define STATS_REPORT_SECONDS     5.0    // Per screen stats report interval
 
 typedef enum { TITLE = 0, GAMEPLAY, ENDING, WIN, CREDITS } GameScreen;
 
@@ -64,6 +115,17 @@ int seaScrolling = 0;
 // Define current screen
 GameScreen currentScreen = 0;
 
+// Define world variables (rails are laid out in world space, camera scrolls vertically)
+int railCount = 5;
+int enemyCount = 5*ENEMIES_PER_RAIL;
+int worldHeight = 5*120 + 120;
+Camera2D camera = { 0 };
+
+// Define rails spatial index: linked list of active enemies per rail, rebuilt every gameplay frame
+int railFirstEnemy[MAX_RAILS];
+int enemyNextInRail[MAX_ENEMIES];
+int railIndexedEnemies = 0;
+
 // Define player variables
 int playerRail = 1;
 Rectangle playerBounds;
@@ -90,30 +152,249 @@ int foodBar = 0;
 int framesCounter = 0;
 
 float timeCounter = 0;
-    
+
+// Define input script variables (fixed key presses per frame, for reproducible runs)
+unsigned int frameIndex = 0;
+int scriptFrame[MAX_SCRIPT_EVENTS];
+int scriptKey[MAX_SCRIPT_EVENTS];
+int scriptCount = 0;
+bool scriptMode = false;
+
+// Define idle screens variables
+bool idleEnabled = true;
+bool idleThrottled = false;
+int idleInputFrames = 0;                // Frames since last input, stops counting once throttled
+#if defined(SUPPORT_IDLE_THROTTLE)
+bool idleKeyActivity = false;           // Key event received since last update
+bool idleKeyLatch[GLFW_KEY_LAST + 1] = { 0 };   // Keys pressed since last update, even if already released
+GLFWkeyfun idlePrevKeyCallback = NULL;  // raylib key callback, events are forwarded to it
+#endif
+RenderTexture2D idleBase;               // Static layers of current idle screen
+RenderTexture2D idleFrame;              // Composed idle screen, only damaged regions are redrawn
+int idleScreen = -1;                    // Screen composed in idleBase (-1 = none)
+bool idleBlink = false;
+int idleSeaScrolling = 0;
+Rectangle idleSeaRegion;                // Rows covered by sea texture opaque pixels
+
+// Define stats variables (per screen utilization report)
+bool statsMode = false;
+GameScreen statsScreen = TITLE;
+double statsLastTime = 0.0;
+clock_t statsLastClock = 0;
+double statsWallTime[CREDITS + 1] = { 0 };
+double statsCpuTime[CREDITS + 1] = { 0 };
+double statsGpuTime[CREDITS + 1] = { 0 };
+double statsRedrawn[CREDITS + 1] = { 0 };     // Pixels redrawn
+int statsFrames[CREDITS + 1] = { 0 };
+int statsThrottledFrames[CREDITS + 1] = { 0 };
+double statsDrawn[CREDITS + 1] = { 0 };       // Enemies submitted for drawing
+double statsCulled[CREDITS + 1] = { 0 };      // Active enemies out of camera view
+
+#if defined(SUPPORT_GPU_TIMING)
+unsigned int gpuQueries[GPU_QUERY_COUNT];
+GameScreen gpuQueryScreen[GPU_QUERY_COUNT];
+unsigned int gpuQueryIssued = 0;
+unsigned int gpuQueryRead = 0;
+#endif
+
+#if defined(SUPPORT_CAPTURE_MODE)
+// Define capture mode variables
+bool captureMode = false;
+bool captureHeadless = false;
+bool capturePng = false;
+const char *captureDir = "capture";
+unsigned int captureFrames = 0;         // Frames to capture before exit (0 = until window closed)
+
+RenderTexture2D captureTarget;
+unsigned int capturePbo[CAPTURE_PBO_COUNT];
+unsigned int captureIssued = 0;         // Frames read into a PBO
+unsigned int captureDrained = 0;        // Frames copied out of a PBO
+unsigned int capturePboFrame[CAPTURE_PBO_COUNT];    // Frame index read into each PBO, names output file
+unsigned int captureErrors = 0;         // Frames that could not be read back or written
+int captureWriterCount = 0;
+double captureStartTime = 0.0;
+
+unsigned char *capturePool[CAPTURE_POOL_SIZE];
+int captureFree[CAPTURE_POOL_SIZE];
+int captureFreeCount = 0;
+int capturePending[CAPTURE_POOL_SIZE];
+unsigned int capturePendingFrame[CAPTURE_POOL_SIZE];
+int capturePendingHead = 0;
+int capturePendingCount = 0;
+bool captureQuit = false;
+
+pthread_t captureWriters[CAPTURE_WRITER_THREADS];
+pthread_mutex_t captureLock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t captureCanWrite = PTHREAD_COND_INITIALIZER;
+pthread_cond_t captureCanFill = PTHREAD_COND_INITIALIZER;
+#endif
+
 //----------------------------------------------------------------------------------
 // Module Functions Declaration
 //----------------------------------------------------------------------------------
 void UpdateDrawFrame(void);     // Update and Draw one frame
+bool IsGameKeyPressed(int key); // Check key pressed, from input script if loaded
+bool LoadInputScript(const char *fileName); // Load "<frame> <KEY>" lines into input script
+
+void DrawBackground(bool drawSea);  // Draw sky, mountains and (optionally) sea layers
+void DrawSea(void);                 // Draw scrolling sea layer
+void ForceOpaqueAlpha(void);        // Set alpha of current render target to 255, keeping colors
+void DrawScreen(bool drawBlink);    // Draw current screen elements over background
+bool GetBlinkText(const char **text, Vector2 *position, float *spacing, Color *color); // Get blinking prompt of current screen
+void DrawBlinkText(void);           // Draw blinking prompt of current screen
+
+void UpdateGameCamera(bool snap);   // Update camera to follow player, clamped to world bounds
+void UpdateRailIndex(void);         // Rebuild per rail lists of active enemies
+void GetVisibleRails(Rectangle view, int *firstRail, int *lastRail);    // Get rails range overlapping view
+Texture2D GetEnemyTexture(int type);    // Get enemy texture by type
+
+bool IsIdleScreen(GameScreen screen);   // Check if screen uses the cached idle frame
+void UpdateIdleThrottle(void);      // Update idle throttling from keyboard activity
+#if defined(SUPPORT_IDLE_THROTTLE)
+void IdleKeyCallback(GLFWwindow *window, int key, int scancode, int action, int mods);  // Latch key presses between updates
+#endif
+void UpdateIdleFrame(void);         // Update damaged regions of idle frame
+void RedrawIdleRegion(Rectangle region, bool drawBlink);   // Redraw one region of idle frame
+
+void UpdateStats(void);             // Accumulate previous frame times into its screen stats
+void ReportStats(GameScreen screen);    // Print and reset screen stats
+void BeginGpuTimer(void);           // Begin GPU timer query for current frame
+void EndGpuTimer(void);             // End GPU timer query for current frame
+void ReadGpuTimers(bool wait);      // Collect finished GPU timer queries
+
+#if defined(SUPPORT_CAPTURE_MODE)
+bool InitCapture(void);         // Create capture render target, PBOs ring and writer threads
+void CaptureFrame(void);        // Queue async readback of capture render target
+void DrainCaptureFrame(void);   // Copy oldest readback out of its PBO into writers queue
+void *CaptureWriterThread(void *arg); // Encode queued frames to disk
+void ReleaseCapture(void);      // Stop writer threads and release capture resources
+bool CloseCapture(void);        // Flush pending frames and release capture resources, false if frames are missing
+#endif
 
 //----------------------------------------------------------------------------------
 // Main Enry Point
 //----------------------------------------------------------------------------------
-int main()
+int main(int argc, char *argv[])
 {
     // Initialization
     //--------------------------------------------------------------------------------------
+    unsigned int randomSeed = 0;
+    bool randomSeeded = false;
+    int exitCode = 0;
+    
+    // Parse command line options
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--script") == 0) && (i + 1 < argc))
+        {
+            if (!LoadInputScript(argv[++i])) return 1;
+        }
+        else if ((strcmp(argv[i], "--seed") == 0) && (i + 1 < argc))
+        {
+            randomSeed = (unsigned int)atoi(argv[++i]);
+            randomSeeded = true;
+        }
+        else if ((strcmp(argv[i], "--rails") == 0) && (i + 1 < argc))
+        {
+            railCount = atoi(argv[++i]);
+            
+            if (railCount < MIN_RAILS) railCount = MIN_RAILS;
+            else if (railCount > MAX_RAILS) railCount = MAX_RAILS;
+        }
+        else if (strcmp(argv[i], "--no-idle") == 0) idleEnabled = false;
+        else if (strcmp(argv[i], "--stats") == 0) statsMode = true;
+#if defined(SUPPORT_CAPTURE_MODE)
+        else if ((strcmp(argv[i], "--capture") == 0) && (i + 1 < argc))
+        {
+            captureMode = true;
+            captureDir = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--frames") == 0) && (i + 1 < argc)) captureFrames = (unsigned int)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--headless") == 0) captureHeadless = true;
+        else if (strcmp(argv[i], "--png") == 0) capturePng = true;
+#endif
+        else
+        {
+            printf("usage: %s [--script file] [--seed n] [--rails n] [--no-idle] [--stats]"
+#if defined(SUPPORT_CAPTURE_MODE)
+                   " [--capture dir [--headless] [--png] [--frames n]]"
+#endif
+                   "\n", argv[0]);
+            return 1;
+        }
+    }
+    
+#if defined(SUPPORT_CAPTURE_MODE)
+    if (captureHeadless)
+    {
+        // Headless only makes sense while capturing, and needs a frame limit to finish
+        captureMode = true;
+        if (captureFrames == 0) captureFrames = CAPTURE_DEFAULT_FRAMES;
+        
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    }
+    
+    if (captureMode)
+    {
+        if (!DirectoryExists(captureDir))
+        {
+            TraceLog(LOG_ERROR, "CAPTURE: Directory does not exist: %s", captureDir);
+            return 1;
+        }
+    }
+#endif
+    
+    // World covers all rails, 5 rails fill the screen exactly
+    enemyCount = railCount*ENEMIES_PER_RAIL;
+    worldHeight = railCount*120 + 120;
+    if (worldHeight < screenHeight) worldHeight = screenHeight;
+    
+    camera.zoom = 1.0f;
     
     // Init window
     InitWindow(screenWidth, screenHeight, "Who Did 9/11 ?");
     
+    // NOTE: InitWindow() seeds rand() with current time, GetRandomValue() relies on it
+    // Scripted runs and captures use a fixed seed by default so they produce identical frames
+    bool reproducible = scriptMode;
+#if defined(SUPPORT_CAPTURE_MODE)
+    if (captureMode) reproducible = true;
+#endif
+    if (randomSeeded || reproducible) srand(randomSeed);
+    
+    // Scripted runs and captures keep the plain draw path, captures render into their own target
+    if (scriptMode) idleEnabled = false;
+#if defined(SUPPORT_CAPTURE_MODE)
+    if (captureMode) idleEnabled = false;
+#endif
+    
     // Initialize audio device
     InitAudioDevice();      
     
     // Load game resources: textures
     sky = LoadTexture("resources/sky.png");
     mountains = LoadTexture("resources/mountains.png");
-    sea = LoadTexture("resources/sea.png");
+    
+    // Sea texture is loaded as image first to find its opaque rows, the only ones its scrolling damages
+    Image seaImage = LoadImage("resources/sea.png");
+    Color *seaPixels = LoadImageColors(seaImage);
+    int seaTop = 0;
+    
+    while ((seaTop < seaImage.height - 1) && (seaPixels != NULL))
+    {
+        bool opaqueRow = false;
+        for (int x = 0; x < seaImage.width; x++) if (seaPixels[seaTop*seaImage.width + x].a > 0) { opaqueRow = true; break; }
+        
+        if (opaqueRow) break;
+        seaTop++;
+    }
+    
+    idleSeaRegion = (Rectangle){ 0, seaTop, screenWidth, ((seaImage.height < screenHeight)? seaImage.height : screenHeight) - seaTop };
+    
+    UnloadImageColors(seaPixels);
+    sea = LoadTextureFromImage(seaImage);
+    UnloadImage(seaImage);
+    
     turtle = LoadTexture("resources/eagle.png");
     gamera = LoadTexture("resources/henric.png");
     shark = LoadTexture("resources/rafale.png");
@@ -142,7 +423,7 @@ int main()
     playerBounds = (Rectangle){ 30 + 14, playerRail*120 + 90 + 14, 100, 100 };
     
     // Init enemies variables
-    for (int i = 0; i < MAX_ENEMIES; i++)
+    for (int i = 0; i < enemyCount; i++)
     {
         // Define enemy type (all same probability)
         //enemyType[i] = GetRandomValue(0, 3);
@@ -156,33 +437,78 @@ int main()
         else enemyType[i] = 3;
 
         // define enemy rail
-        enemyRail[i] = GetRandomValue(0, 4);
+        enemyRail[i] = GetRandomValue(0, railCount - 1);
 
         // Make sure not two consecutive enemies in the same row
-        if (i > 0) while (enemyRail[i] == enemyRail[i - 1]) enemyRail[i] = GetRandomValue(0, 4);
+        if (i > 0) while (enemyRail[i] == enemyRail[i - 1]) enemyRail[i] = GetRandomValue(0, railCount - 1);
         
         enemyBounds[i] = (Rectangle){ screenWidth + 14, 120*enemyRail[i] + 90 + 14, 100, 100 };
         enemyActive[i] = false;
     }
 
-    ttowerBounds = (Rectangle){ screenWidth + 14, 120 + 90, 100, screenHeight };
+    ttowerBounds = (Rectangle){ screenWidth + 14, 120 + 90, 100, worldHeight - (120 + 90) };
     ttowerActive = false;
     
+    if (idleEnabled)
+    {
+        idleBase = LoadRenderTexture(screenWidth, screenHeight);
+        idleFrame = LoadRenderTexture(screenWidth, screenHeight);
+        
+#if defined(SUPPORT_IDLE_THROTTLE)
+        idlePrevKeyCallback = glfwSetKeyCallback(glfwGetCurrentContext(), IdleKeyCallback);
+#endif
+    }
+    
+#if defined(SUPPORT_GPU_TIMING)
+    if (statsMode) glGenQueries(GPU_QUERY_COUNT, gpuQueries);
+#endif
+    
 #if defined(PLATFORM_WEB)
     emscripten_set_main_loop(UpdateDrawFrame, 60, 1);
 #else
+#if defined(SUPPORT_CAPTURE_MODE)
+    if (captureMode && !InitCapture()) exitCode = 1;
+    
+    // Game logic advances a fixed step per frame, so scripted captures can run unthrottled
+    if (captureMode && (captureHeadless || scriptMode)) SetTargetFPS(0);
+    else
+#endif
     SetTargetFPS(60);   // Set our game to run at 60 frames-per-second
     //--------------------------------------------------------------------------------------
     
     // Main game loop
-    while (!WindowShouldClose())    // Detect window close button or ESC key
+    while ((exitCode == 0) && !WindowShouldClose())    // Detect window close button or ESC key
     {
+#if defined(SUPPORT_CAPTURE_MODE)
+        if (captureMode && (captureFrames > 0) && (frameIndex >= captureFrames)) break;
+#endif
         UpdateDrawFrame();
     }
+    
+#if defined(SUPPORT_CAPTURE_MODE)
+    // Missing frames must fail golden-image runs
+    if (captureMode && (exitCode == 0) && !CloseCapture()) exitCode = 1;
+#endif
 #endif
 
     // De-Initialization
     //--------------------------------------------------------------------------------------
+    if (statsMode)
+    {
+        ReadGpuTimers(true);
+        ReportStats(statsScreen);
+    }
+    
+#if defined(SUPPORT_GPU_TIMING)
+    if (statsMode) glDeleteQueries(GPU_QUERY_COUNT, gpuQueries);
+#endif
+    
+    if (idleEnabled)
+    {
+        UnloadRenderTexture(idleBase);
+        UnloadRenderTexture(idleFrame);
+    }
+    
     
     // Unload textures
     UnloadTexture(sky);
@@ -212,7 +538,7 @@ int main()
     CloseWindow();              // Close window and OpenGL context
     //--------------------------------------------------------------------------------------
     
-    return 0;
+    return exitCode;
 }
 
 //----------------------------------------------------------------------------------
@@ -222,9 +548,17 @@ void UpdateDrawFrame(void)
 {
     // Update
     //----------------------------------------------------------------------------------
+    if (statsMode) UpdateStats();
+    
     UpdateMusicStream(music);   // Refill music stream buffers (if required)
+    
+    // Idle screens tick slower after a while without input, logic advances several frames per tick
+    if (idleEnabled) UpdateIdleThrottle();
+    
+    int frameStep = idleThrottled? IDLE_REDRAW_STEP : 1;
         
-    framesCounter++;
+    framesCounter += frameStep;
+    frameIndex++;
 
     timeCounter += 0.01;
 
@@ -234,11 +568,11 @@ void UpdateDrawFrame(void)
         case TITLE:
         {
             // Sea scrolling
-            seaScrolling -= 2;
+            seaScrolling -= 2*frameStep;
             if (seaScrolling <= -screenWidth) seaScrolling = 0;
         
             // Press enter to change to gameplay screen
-            if (IsKeyPressed(KEY_ENTER))
+            if (IsGameKeyPressed(KEY_ENTER))
             {
                 currentScreen = GAMEPLAY;
                 framesCounter = 0;
@@ -256,25 +590,30 @@ void UpdateDrawFrame(void)
             if (seaScrolling <= -screenWidth) seaScrolling = 0; 
         
             // Player movement logic
-            if (IsKeyPressed(KEY_DOWN)) playerRail++;
-            else if (IsKeyPressed(KEY_UP)) playerRail--;
+            if (IsGameKeyPressed(KEY_DOWN)) playerRail++;
+            else if (IsGameKeyPressed(KEY_UP)) playerRail--;
             
             // Check player not out of rails
-            if (playerRail > 4) playerRail = 4;
+            if (playerRail > railCount - 1) playerRail = railCount - 1;
             else if (playerRail < 0) playerRail = 0;
         
             // Update player bounds
             playerBounds = (Rectangle){ 30 + 14, playerRail*120 + 90 + 14, 100, 100 };
             
+            UpdateGameCamera(false);
+            
             // Enemies activation logic (every 40 frames)        
             if (framesCounter > 40)
             {
-                for (int i = 0; i < MAX_ENEMIES && distance < 1105; i++)
+                // Activate one enemy per 5 rails, keeps same enemies density whatever the world size
+                int activations = (railCount + 4)/5;
+                
+                for (int i = 0; i < enemyCount && distance < 1105 && activations > 0; i++)
                 {
                     if (enemyActive[i] == false)
                     {
                         enemyActive[i] = true;
-                        i = MAX_ENEMIES;
+                        activations--;
                     }
                 }
                 
@@ -285,7 +624,7 @@ void UpdateDrawFrame(void)
             }
             
             // Enemies logic
-            for (int i = 0; i < MAX_ENEMIES; i++)
+            for (int i = 0; i < enemyCount; i++)
             {
                 if (enemyActive[i])
                 {
@@ -297,10 +636,10 @@ void UpdateDrawFrame(void)
                 {
                     enemyActive[i] = false;
                     enemyType[i] = GetRandomValue(0, 3);
-                    enemyRail[i] = GetRandomValue(0, 4);
+                    enemyRail[i] = GetRandomValue(0, railCount - 1);
                     
                     // Make sure not two consecutive enemies in the same row
-                    if (i > 0) while (enemyRail[i] == enemyRail[i - 1]) enemyRail[i] = GetRandomValue(0, 4);
+                    if (i > 0) while (enemyRail[i] == enemyRail[i - 1]) enemyRail[i] = GetRandomValue(0, railCount - 1);
                     
                     enemyBounds[i] = (Rectangle){ screenWidth + 14, 120*enemyRail[i] + 90 + 14, 100, 100 };
                 }
@@ -312,7 +651,7 @@ void UpdateDrawFrame(void)
             if (!gameraMode) enemySpeed += 0.005;
             
             // Check collision player vs enemies
-            for (int i = 0; i < MAX_ENEMIES; i++)
+            for (int i = 0; i < enemyCount; i++)
             {
                 if (enemyActive[i])
                 {
@@ -332,10 +671,10 @@ void UpdateDrawFrame(void)
                                 
                                 // After enemy deactivation, reset enemy parameters to be reused
                                 enemyType[i] = GetRandomValue(0, 3);
-                                enemyRail[i] = GetRandomValue(0, 4);
+                                enemyRail[i] = GetRandomValue(0, railCount - 1);
                                 
                                 // Make sure not two consecutive enemies in the same row
-                                if (i > 0) while (enemyRail[i] == enemyRail[i - 1]) enemyRail[i] = GetRandomValue(0, 4);
+                                if (i > 0) while (enemyRail[i] == enemyRail[i - 1]) enemyRail[i] = GetRandomValue(0, railCount - 1);
                                 
                                 enemyBounds[i] = (Rectangle){ screenWidth + 14, 120*enemyRail[i] + 90 + 14, 100, 100 };
                                 
@@ -358,10 +697,10 @@ void UpdateDrawFrame(void)
                         {
                             enemyActive[i] = false;
                             enemyType[i] = GetRandomValue(0, 3);
-                            enemyRail[i] = GetRandomValue(0, 4);
+                            enemyRail[i] = GetRandomValue(0, railCount - 1);
                             
                             // Make sure not two consecutive enemies in the same row
-                            if (i > 0) while (enemyRail[i] == enemyRail[i - 1]) enemyRail[i] = GetRandomValue(0, 4);
+                            if (i > 0) while (enemyRail[i] == enemyRail[i - 1]) enemyRail[i] = GetRandomValue(0, railCount - 1);
                             
                             enemyBounds[i] = (Rectangle){ screenWidth + 14, 120*enemyRail[i] + 90 + 14, 100, 100 };
                             
@@ -416,17 +755,18 @@ void UpdateDrawFrame(void)
         case ENDING:
         {
             // Press enter to play again
-            if (IsKeyPressed(KEY_ENTER))
+            if (IsGameKeyPressed(KEY_ENTER))
             {
                 currentScreen = GAMEPLAY;
                 
                 // Reset player
                 playerRail = 1;
                 playerBounds = (Rectangle){ 30 + 14, playerRail*120 + 90 + 14, 100, 100 };
+                UpdateGameCamera(true);
                 gameraMode = false;
                 
                 // Reset enemies data
-                for (int i = 0; i < MAX_ENEMIES; i++)
+                for (int i = 0; i < enemyCount; i++)
                 {
                     int enemyProb = GetRandomValue(0, 100);
                     
@@ -436,16 +776,16 @@ void UpdateDrawFrame(void)
                     else enemyType[i] = 3;
                     
                     //enemyType[i] = GetRandomValue(0, 3);
-                    enemyRail[i] = GetRandomValue(0, 4);
+                    enemyRail[i] = GetRandomValue(0, railCount - 1);
 
                     // Make sure not two consecutive enemies in the same row
-                    if (i > 0) while (enemyRail[i] == enemyRail[i - 1]) enemyRail[i] = GetRandomValue(0, 4);
+                    if (i > 0) while (enemyRail[i] == enemyRail[i - 1]) enemyRail[i] = GetRandomValue(0, railCount - 1);
                     
                     enemyBounds[i] = (Rectangle){ screenWidth + 14, 120*enemyRail[i] + 90 + 14, 100, 100 };
                     enemyActive[i] = false;
                 }
                 
-                ttowerBounds = (Rectangle){ screenWidth + 14, 120 + 90, 100, screenHeight };
+                ttowerBounds = (Rectangle){ screenWidth + 14, 120 + 90, 100, worldHeight - (120 + 90) };
                 ttowerActive = false;
 
                 enemySpeed = 10;
@@ -456,7 +796,7 @@ void UpdateDrawFrame(void)
                 foodBar = 0;
                 framesCounter = 0;
             }
-            if (IsKeyPressed(KEY_C)) {
+            if (IsGameKeyPressed(KEY_C)) {
                 currentScreen = CREDITS;
             }
   
@@ -464,17 +804,18 @@ void UpdateDrawFrame(void)
         case WIN:
         {
             // Press enter to play again
-            if (IsKeyPressed(KEY_ENTER))
+            if (IsGameKeyPressed(KEY_ENTER))
             {
                 currentScreen = GAMEPLAY;
                 
                 // Reset player
                 playerRail = 1;
                 playerBounds = (Rectangle){ 30 + 14, playerRail*120 + 90 + 14, 100, 100 };
+                UpdateGameCamera(true);
                 gameraMode = false;
                 
                 // Reset enemies data
-                for (int i = 0; i < MAX_ENEMIES; i++)
+                for (int i = 0; i < enemyCount; i++)
                 {
                     int enemyProb = GetRandomValue(0, 100);
                     
@@ -484,16 +825,16 @@ void UpdateDrawFrame(void)
                     else enemyType[i] = 3;
                     
                     //enemyType[i] = GetRandomValue(0, 3);
-                    enemyRail[i] = GetRandomValue(0, 4);
+                    enemyRail[i] = GetRandomValue(0, railCount - 1);
 
                     // Make sure not two consecutive enemies in the same row
-                    if (i > 0) while (enemyRail[i] == enemyRail[i - 1]) enemyRail[i] = GetRandomValue(0, 4);
+                    if (i > 0) while (enemyRail[i] == enemyRail[i - 1]) enemyRail[i] = GetRandomValue(0, railCount - 1);
                     
                     enemyBounds[i] = (Rectangle){ screenWidth + 14, 120*enemyRail[i] + 90 + 14, 100, 100 };
                     enemyActive[i] = false;
                 }
                 
-                ttowerBounds = (Rectangle){ screenWidth + 14, 120 + 90, 100, screenHeight };
+                ttowerBounds = (Rectangle){ screenWidth + 14, 120 + 90, 100, worldHeight - (120 + 90) };
                 ttowerActive = false;
 
                 enemySpeed = 10;
@@ -504,22 +845,23 @@ void UpdateDrawFrame(void)
                 foodBar = 0;
                 framesCounter = 0;
             }
-            if (IsKeyPressed(KEY_C)) {
+            if (IsGameKeyPressed(KEY_C)) {
                 currentScreen = CREDITS;
             }
   
         } break;
         case CREDITS:
         {
-            if (IsKeyPressed(KEY_T)) {
+            if (IsGameKeyPressed(KEY_T)) {
                 currentScreen = TITLE;
 
                 playerRail = 1;
                 playerBounds = (Rectangle){ 30 + 14, playerRail*120 + 90 + 14, 100, 100 };
+                UpdateGameCamera(true);
                 gameraMode = false;
                 
                 // Reset enemies data
-                for (int i = 0; i < MAX_ENEMIES; i++)
+                for (int i = 0; i < enemyCount; i++)
                 {
                     int enemyProb = GetRandomValue(0, 100);
                     
@@ -529,16 +871,16 @@ void UpdateDrawFrame(void)
                     else enemyType[i] = 3;
                     
                     //enemyType[i] = GetRandomValue(0, 3);
-                    enemyRail[i] = GetRandomValue(0, 4);
+                    enemyRail[i] = GetRandomValue(0, railCount - 1);
 
                     // Make sure not two consecutive enemies in the same row
-                    if (i > 0) while (enemyRail[i] == enemyRail[i - 1]) enemyRail[i] = GetRandomValue(0, 4);
+                    if (i > 0) while (enemyRail[i] == enemyRail[i - 1]) enemyRail[i] = GetRandomValue(0, railCount - 1);
                     
                     enemyBounds[i] = (Rectangle){ screenWidth + 14, 120*enemyRail[i] + 90 + 14, 100, 100 };
                     enemyActive[i] = false;
                 }
                 
-                ttowerBounds = (Rectangle){ screenWidth + 14, 120 + 90, 100, screenHeight };
+                ttowerBounds = (Rectangle){ screenWidth + 14, 120 + 90, 100, worldHeight - (120 + 90) };
                 ttowerActive = false;
 
                 enemySpeed = 10;
@@ -552,46 +894,147 @@ void UpdateDrawFrame(void)
         } break;
         default: break;
     }
+    
+#if defined(SUPPORT_IDLE_THROTTLE)
+    // Latched presses were consumed by this update
+    if (idleEnabled) memset(idleKeyLatch, 0, sizeof(idleKeyLatch));
+#endif
     //----------------------------------------------------------------------------------
     
     // Draw
     //----------------------------------------------------------------------------------
+    BeginGpuTimer();
+    
+    if (idleEnabled && IsIdleScreen(currentScreen))
+    {
+        // Static screens only redraw changed regions of a cached frame, then present it
+        UpdateIdleFrame();
+        
+        BeginDrawing();
+        
+            ClearBackground(BLACK);
+            
+            // NOTE: Render texture must be y-flipped due to default OpenGL coordinates (left-bottom)
+            DrawTextureRec(idleFrame.texture, (Rectangle){ 0, 0, idleFrame.texture.width, -idleFrame.texture.height }, (Vector2){ 0, 0 }, WHITE);
+            
+            EndGpuTimer();
+        
+        EndDrawing();
+        
+        return;
+    }
+    
+    idleScreen = -1;    // Compose idle frame again on next idle screen, scores may have changed
+    
+#if defined(SUPPORT_CAPTURE_MODE)
+    if (captureMode) BeginTextureMode(captureTarget);
+    else
+#endif
     BeginDrawing();
     
         ClearBackground(RAYWHITE);
         
         // Draw background (common to all screens)
-        DrawTexture(sky, 0, 0, WHITE);
+        DrawBackground(true);
         
-        DrawTexture(mountains, backScrolling, 0, WHITE);
-        DrawTexture(mountains, screenWidth + backScrolling, 0, WHITE);
+        DrawScreen((framesCounter/30) % 2);
         
-        if (!gameraMode)
-        {
-            DrawTexture(sea, seaScrolling, 0, BEIGE);
-            DrawTexture(sea, screenWidth + seaScrolling, 0, BEIGE);
-        }
-        else
+        statsRedrawn[statsScreen] += (double)screenWidth*screenHeight;
+
+#if defined(SUPPORT_CAPTURE_MODE)
+    if (captureMode)
+    {
+        // Captured frames must be opaque, alpha blending also lowered target alpha
+        ForceOpaqueAlpha();
+        
+        EndTextureMode();
+        CaptureFrame();
+        
+        // Present capture target, still required to poll input events while headless
+        BeginDrawing();
+            ClearBackground(BLACK);
+            
+            // NOTE: Render texture must be y-flipped due to default OpenGL coordinates (left-bottom)
+            if (!captureHeadless) DrawTextureRec(captureTarget.texture, (Rectangle){ 0, 0, captureTarget.texture.width, -captureTarget.texture.height }, (Vector2){ 0, 0 }, WHITE);
+            
+            EndGpuTimer();
+        EndDrawing();
+    }
+    else
+#endif
+    {
+        EndGpuTimer();
+        EndDrawing();
+    }
+    //----------------------------------------------------------------------------------
+}
+
+// Draw sky, mountains and (optionally) sea layers
+void DrawBackground(bool drawSea)
+{
+    DrawTexture(sky, 0, 0, WHITE);
+    
+    DrawTexture(mountains, backScrolling, 0, WHITE);
+    DrawTexture(mountains, screenWidth + backScrolling, 0, WHITE);
+    
+    if (drawSea) DrawSea();
+}
+
+// Draw scrolling sea layer
+void DrawSea(void)
+{
+    if (!gameraMode)
+    {
+        DrawTexture(sea, seaScrolling, 0, BEIGE);
+        DrawTexture(sea, screenWidth + seaScrolling, 0, BEIGE);
+    }
+    else
+    {
+        DrawTexture(sea, seaScrolling, 0, BEIGE);
+        DrawTexture(sea, screenWidth + seaScrolling, 0, BEIGE);
+    }
+}
+
+// Set alpha of current render target to 255, keeping colors
+// NOTE: Default blending (SRC_ALPHA, ONE_MINUS_SRC_ALPHA) also applies to alpha channel, so render
+// textures are left translucent wherever translucent pixels were drawn; additive black fixes alpha only
+void ForceOpaqueAlpha(void)
+{
+    BeginBlendMode(BLEND_ADDITIVE);
+        DrawRectangle(0, 0, screenWidth, screenHeight, BLACK);
+    EndBlendMode();
+}
+
+// Draw current screen elements over background
+void DrawScreen(bool drawBlink)
+{
+    switch (currentScreen)
+    {
+        case TITLE:
         {
-            DrawTexture(sea, seaScrolling, 0, BEIGE);
-            DrawTexture(sea, screenWidth + seaScrolling, 0, BEIGE);
-        }
+            // Draw title
+            DrawTextEx(font, "WHO DID 9/11", (Vector2){ screenWidth/2 - 300, 220 }, 100, 1, RED);
+            
+            // Draw blinking text
+            if (drawBlink) DrawBlinkText();
         
-        switch (currentScreen)
+        } break;
+        case GAMEPLAY:
         {
-            case TITLE:
-            {
-                // Draw title
-                DrawTextEx(font, "WHO DID 9/11", (Vector2){ screenWidth/2 - 300, 220 }, 100, 1, RED);
-                
-                // Draw blinking text
-                if ((framesCounter/30) % 2) DrawTextEx(font, "PRESS ENTER", (Vector2){ screenWidth/2 - 150, 480 }, font.baseSize, 1, WHITE);
+            // Only rails overlapping camera view are visited, draw cost does not grow with world size
+            Rectangle view = { camera.target.x, camera.target.y, screenWidth, screenHeight };
+            int firstRail = 0;
+            int lastRail = 0;
+            
+            GetVisibleRails(view, &firstRail, &lastRail);
+            
+            // Enemies keep simulating off screen, index them by rail for culling
+            UpdateRailIndex();
+            
+            BeginMode2D(camera);
             
-            } break;
-            case GAMEPLAY:
-            {
                 // Draw water lines
-                for (int i = 0; i < 5; i++) DrawRectangle(0, i*120 + 120, screenWidth, 110, Fade(SKYBLUE, 0.1f));
+                for (int i = firstRail; i <= lastRail; i++) DrawRectangle(0, i*120 + 120, screenWidth, 110, Fade(SKYBLUE, 0.1f));
                 
                 // Draw player
                 if (!gameraMode) DrawTexture(turtle, playerBounds.x - 14, playerBounds.y - 14, WHITE);
@@ -603,19 +1046,20 @@ void UpdateDrawFrame(void)
                 
                 // Draw enemies
                 if (distance < 1109.0f) {
-                    for (int i = 0; i < MAX_ENEMIES; i++)
+                    int drawn = 0;
+                    
+                    for (int rail = firstRail; rail <= lastRail; rail++)
                     {
-                        if (enemyActive[i]) 
+                        for (int i = railFirstEnemy[rail]; i != -1; i = enemyNextInRail[i])
                         {
+                            Texture2D texture = GetEnemyTexture(enemyType[i]);
+                            
+                            // Enemies waiting at spawn point or gone past left border are culled
+                            if (!CheckCollisionRecs(view, (Rectangle){ enemyBounds[i].x - 14, enemyBounds[i].y - 14, texture.width, texture.height })) continue;
+                            
                             // Draw enemies
-                            switch(enemyType[i])
-                            {
-                                case 0: DrawTexture(shark, enemyBounds[i].x - 14, enemyBounds[i].y - 14, WHITE); break;
-                                case 1: DrawTexture(orca, enemyBounds[i].x - 14, enemyBounds[i].y - 14, WHITE); break;
-                                case 2: DrawTexture(swhale, enemyBounds[i].x - 14, enemyBounds[i].y - 14, WHITE); break;
-                                case 3: DrawTexture(fish, enemyBounds[i].x - 14, enemyBounds[i].y - 14, WHITE); break;
-                                default: break;
-                            }
+                            DrawTexture(texture, enemyBounds[i].x - 14, enemyBounds[i].y - 14, WHITE);
+                            drawn++;
 
                             // Draw enemies bounding boxes
                             /*
@@ -630,74 +1074,725 @@ void UpdateDrawFrame(void)
                             */
                         }
                     }
+                    
+                    statsDrawn[statsScreen] += drawn;
+                    statsCulled[statsScreen] += railIndexedEnemies - drawn;
                 }
                 else
-                    DrawTexture(ttower, ttowerBounds.x - 14, ttowerBounds.y - 14, WHITE);
-                
-                // Draw gameplay interface
-                DrawRectangle(20, 20, 400, 40, Fade(GRAY, 0.4f));
-                DrawRectangle(20, 20, foodBar, 40, ORANGE);
-                DrawRectangleLines(20, 20, 400, 40, BLACK);
-                
-                DrawTextEx(font, TextFormat("SCORE: %04i", score), (Vector2){ screenWidth - 300, 20 }, font.baseSize, -2, ORANGE);
-                DrawTextEx(font, TextFormat("DISTANCE: %04i", (int)distance), (Vector2){ 550, 20 }, font.baseSize, -2, ORANGE);
-                
-                if (gameraMode)
                 {
-                    DrawText("HENRIC MODE", 60, 22, 40, GRAY);
-                    DrawTexture(gframe, 0, 0, Fade(WHITE, 0.5f));
+                    // Tower sprite covers its whole collision height, stretched down when taller than texture
+                    Rectangle towerRec = { ttowerBounds.x - 14, ttowerBounds.y - 14, ttower.width, ttowerBounds.height + 14 };
+                    
+                    if (CheckCollisionRecs(view, towerRec))
+                    {
+                        float towerHeight = (towerRec.height > ttower.height)? towerRec.height : ttower.height;
+                        DrawTexturePro(ttower, (Rectangle){ 0, 0, ttower.width, ttower.height }, (Rectangle){ towerRec.x, towerRec.y, ttower.width, towerHeight }, (Vector2){ 0, 0 }, 0.0f, WHITE);
+                    }
                 }
+            
+            EndMode2D();
+            
+            // Draw gameplay interface
+            DrawRectangle(20, 20, 400, 40, Fade(GRAY, 0.4f));
+            DrawRectangle(20, 20, foodBar, 40, ORANGE);
+            DrawRectangleLines(20, 20, 400, 40, BLACK);
+            
+            DrawTextEx(font, TextFormat("SCORE: %04i", score), (Vector2){ screenWidth - 300, 20 }, font.baseSize, -2, ORANGE);
+            DrawTextEx(font, TextFormat("DISTANCE: %04i", (int)distance), (Vector2){ 550, 20 }, font.baseSize, -2, ORANGE);
+            
+            if (gameraMode)
+            {
+                DrawText("HENRIC MODE", 60, 22, 40, GRAY);
+                DrawTexture(gframe, 0, 0, Fade(WHITE, 0.5f));
+            }
+    
+        } break;
+        case ENDING:
+        {
+            // Draw a transparent black rectangle that covers all screen
+            DrawRectangle(0, 0, screenWidth, screenHeight, Fade(BLACK, 0.4f));
+        
+            DrawTextEx(font, "GAME OVER", (Vector2){ 300, 160 }, font.baseSize*3, -2, MAROON);
+            
+            DrawTextEx(font, TextFormat("SCORE: %04i", score), (Vector2){ 680, 350 }, font.baseSize, -2, GOLD);
+            DrawTextEx(font, TextFormat("DISTANCE: %04i", (int)distance), (Vector2){ 290, 350 }, font.baseSize, -2, GOLD);
+            DrawTextEx(font, TextFormat("HISCORE: %04i", hiscore), (Vector2){ 665, 400 }, font.baseSize, -2, ORANGE);
+            DrawTextEx(font, TextFormat("HIDISTANCE: %04i", (int)hidistance), (Vector2){ 270, 400 }, font.baseSize, -2, ORANGE);
+            
+            // Draw blinking text
+            if (drawBlink) DrawBlinkText();
+            DrawTextEx(font, "PRESS C to show CREDITS", (Vector2){ screenWidth/2 - 250, 580 }, font.baseSize, -2, GRAY);
+            
+        } break;
+        case WIN:
+        {
+            // Draw a transparent black rectangle that covers all screen
+            DrawRectangle(0, 0, screenWidth, screenHeight, Fade(BLACK, 0.4f));
+            if (gameraMode)
+                DrawTextEx(font, "HENRIC DID 9/11", (Vector2){ 200, 160 }, font.baseSize*3, -2, MAROON);
+            else
+                DrawTextEx(font, "EAGLE DID 9/11", (Vector2){ 220, 160 }, font.baseSize*3, -2, MAROON);
+            
+            DrawTextEx(font, TextFormat("SCORE: %04i", score), (Vector2){ 680, 350 }, font.baseSize, -2, GOLD);
+            DrawTextEx(font, TextFormat("DISTANCE: %04i", (int)distance), (Vector2){ 290, 350 }, font.baseSize, -2, GOLD);
+            DrawTextEx(font, TextFormat("HISCORE: %04i", hiscore), (Vector2){ 665, 400 }, font.baseSize, -2, ORANGE);
+            DrawTextEx(font, TextFormat("HIDISTANCE: %04i", (int)hidistance), (Vector2){ 270, 400 }, font.baseSize, -2, ORANGE);
+            
+            // Draw blinking text
+            if (drawBlink) DrawBlinkText();
+            DrawTextEx(font, "PRESS C to show CREDITS", (Vector2){ screenWidth/2 - 250, 580 }, font.baseSize, -2, GRAY);
+        } break;
+        case CREDITS:
+        {
+            DrawTextEx(font, "TEAM:", (Vector2){ screenWidth/2 - 50, 120 }, font.baseSize, -2, ORANGE);
+            DrawTextEx(font, "THIBAULT BARBE", (Vector2){ screenWidth/2 - 150, 200 }, font.baseSize, -2, ORANGE);
+            DrawTextEx(font, "BAPTISTE PAUTONNIER", (Vector2){ screenWidth/2 - 150, 250 }, font.baseSize, -2, ORANGE);
+            DrawTextEx(font, "MATTHIEU PILLEUL", (Vector2){ screenWidth/2 - 150, 300 }, font.baseSize, -2, ORANGE);
+            DrawTextEx(font, "CLEMENT BUTET", (Vector2){ screenWidth/2 - 150, 350 }, font.baseSize, -2, ORANGE);
+            DrawTextEx(font, "ANTOINE BOUSSION", (Vector2){ screenWidth/2 - 150, 400 }, font.baseSize, -2, ORANGE);
+            if (drawBlink) DrawBlinkText();
+
+        } break;
+        default: break;
+    }
+}
+
+// Get blinking prompt of current screen, returns false if screen has none
+bool GetBlinkText(const char **text, Vector2 *position, float *spacing, Color *color)
+{
+    switch (currentScreen)
+    {
+        case TITLE: *text = "PRESS ENTER"; *position = (Vector2){ screenWidth/2 - 150, 480 }; *spacing = 1; *color = WHITE; break;
+        case ENDING:
+        case WIN: *text = "PRESS ENTER to REPLAY"; *position = (Vector2){ screenWidth/2 - 250, 520 }; *spacing = -2; *color = LIGHTGRAY; break;
+        case CREDITS: *text = "PRESS T to go back to TITLE"; *position = (Vector2){ screenWidth/2 - 250, 520 }; *spacing = -2; *color = LIGHTGRAY; break;
+        default: return false;
+    }
+    
+    return true;
+}
+
+// Draw blinking prompt of current screen
+void DrawBlinkText(void)
+{
+    const char *text = NULL;
+    Vector2 position = { 0 };
+    float spacing = 0;
+    Color color = WHITE;
+    
+    if (GetBlinkText(&text, &position, &spacing, &color)) DrawTextEx(font, text, position, font.baseSize, spacing, color);
+}
+
+// Update camera to follow player rail, clamped to world bounds (snap skips smoothing, used on game reset)
+void UpdateGameCamera(bool snap)
+{
+    float targetY = playerBounds.y + playerBounds.height/2 - screenHeight/2;
+    
+    if (targetY > worldHeight - screenHeight) targetY = worldHeight - screenHeight;
+    if (targetY < 0) targetY = 0;
+    
+    // Smooth follow, a rail change takes a few frames to scroll
+    if (snap) camera.target.y = targetY;
+    else camera.target.y += (targetY - camera.target.y)*0.2f;
+}
+
+// Rebuild per rail lists of active enemies
+// NOTE: Single pass over enemies, drawing then only visits visible rails
+void UpdateRailIndex(void)
+{
+    for (int rail = 0; rail < railCount; rail++) railFirstEnemy[rail] = -1;
+    
+    railIndexedEnemies = 0;
+    
+    // Reverse order keeps enemies of each rail listed by index
+    for (int i = enemyCount - 1; i >= 0; i--)
+    {
+        if (enemyActive[i])
+        {
+            enemyNextInRail[i] = railFirstEnemy[enemyRail[i]];
+            railFirstEnemy[enemyRail[i]] = i;
+            railIndexedEnemies++;
+        }
+    }
+}
+
+// Get rails range overlapping view, rail r content spans from its sprites top (120*r + 90)
+// to its water line bottom (120*r + 230), sprites are up to 128 pixels high so end before it
+void GetVisibleRails(Rectangle view, int *firstRail, int *lastRail)
+{
+    *firstRail = (int)floorf((view.y - 230)/120.0f) + 1;
+    *lastRail = (int)floorf((view.y + view.height - 90)/120.0f);
+    
+    if (*firstRail < 0) *firstRail = 0;
+    if (*lastRail > railCount - 1) *lastRail = railCount - 1;
+}
+
+// Get enemy texture by type
+Texture2D GetEnemyTexture(int type)
+{
+    switch (type)
+    {
+        case 0: return shark;
+        case 1: return orca;
+        case 2: return swhale;
+        default: return fish;
+    }
+}
+
+// Check if screen is static enough to use the cached idle frame (only sea and blinking prompt change)
+bool IsIdleScreen(GameScreen screen)
+{
+    return (screen != GAMEPLAY);
+}
+
+// Update idle throttling from keyboard activity, target fps drops to IDLE_REDRAW_FPS once throttled
+// NOTE: Key events are latched by IdleKeyCallback(), without GLFW access idle screens keep full rate
+void UpdateIdleThrottle(void)
+{
+#if defined(SUPPORT_IDLE_THROTTLE)
+    bool input = idleKeyActivity;
+    idleKeyActivity = false;
+    
+    if (input || !IsIdleScreen(currentScreen))
+    {
+        idleInputFrames = 0;
+        
+        if (idleThrottled)
+        {
+            idleThrottled = false;
+            SetTargetFPS(60);
+        }
+        
+        return;
+    }
+    
+    if (!idleThrottled)
+    {
+        idleInputFrames++;
+        
+        if (idleInputFrames >= IDLE_TIMEOUT_FRAMES)
+        {
+            idleThrottled = true;
+            SetTargetFPS(IDLE_REDRAW_FPS);
+        }
+    }
+#endif
+}
+
+#if defined(SUPPORT_IDLE_THROTTLE)
+// Latch key presses between updates, at idle rate a press and release can both happen before next update
+void IdleKeyCallback(GLFWwindow *window, int key, int scancode, int action, int mods)
+{
+    if (idlePrevKeyCallback != NULL) idlePrevKeyCallback(window, key, scancode, action, mods);
+    
+    idleKeyActivity = true;
+    
+    if ((action == GLFW_PRESS) && (key >= 0) && (key <= GLFW_KEY_LAST)) idleKeyLatch[key] = true;
+}
+#endif
+
+// Redraw one region of idle frame: cached static layers, then moving layers clipped to region
+// NOTE: Must be called inside BeginTextureMode(idleFrame)
+void RedrawIdleRegion(Rectangle region, bool drawBlink)
+{
+    BeginScissorMode((int)region.x, (int)region.y, (int)region.width, (int)region.height);
+    
+        DrawTextureRec(idleBase.texture, (Rectangle){ 0, 0, idleBase.texture.width, -idleBase.texture.height }, (Vector2){ 0, 0 }, WHITE);
         
-            } break;
-            case ENDING:
+        if (currentScreen == TITLE)
+        {
+            // Title text lays over the scrolling sea, so it is not part of the cached layers
+            DrawSea();
+            DrawScreen(drawBlink);
+        }
+        else if (drawBlink) DrawBlinkText();
+        
+        // Keep idle frame opaque, it replaces the whole back buffer when presented
+        ForceOpaqueAlpha();
+    
+    EndScissorMode();
+    
+    statsRedrawn[statsScreen] += (double)region.width*region.height;
+}
+
+// Update damaged regions of idle frame, static layers are composed once per screen visit
+void UpdateIdleFrame(void)
+{
+    bool blink = (framesCounter/30) % 2;
+    
+    if (idleScreen != (int)currentScreen)
+    {
+        // Title sea keeps scrolling, other screens are fully frozen except their prompt
+        BeginTextureMode(idleBase);
+            ClearBackground(RAYWHITE);
+            
+            if (currentScreen == TITLE) DrawBackground(false);
+            else
             {
-                // Draw a transparent black rectangle that covers all screen
-                DrawRectangle(0, 0, screenWidth, screenHeight, Fade(BLACK, 0.4f));
+                DrawBackground(true);
+                DrawScreen(false);
+            }
             
-                DrawTextEx(font, "GAME OVER", (Vector2){ 300, 160 }, font.baseSize*3, -2, MAROON);
-                
-                DrawTextEx(font, TextFormat("SCORE: %04i", score), (Vector2){ 680, 350 }, font.baseSize, -2, GOLD);
-                DrawTextEx(font, TextFormat("DISTANCE: %04i", (int)distance), (Vector2){ 290, 350 }, font.baseSize, -2, GOLD);
-                DrawTextEx(font, TextFormat("HISCORE: %04i", hiscore), (Vector2){ 665, 400 }, font.baseSize, -2, ORANGE);
-                DrawTextEx(font, TextFormat("HIDISTANCE: %04i", (int)hidistance), (Vector2){ 270, 400 }, font.baseSize, -2, ORANGE);
-                
-                // Draw blinking text
-                if ((framesCounter/30) % 2) DrawTextEx(font, "PRESS ENTER to REPLAY", (Vector2){ screenWidth/2 - 250, 520 }, font.baseSize, -2, LIGHTGRAY);
-                DrawTextEx(font, "PRESS C to show CREDITS", (Vector2){ screenWidth/2 - 250, 580 }, font.baseSize, -2, GRAY);
-                
-            } break;
-            case WIN:
+            // Opaque base fully replaces idle frame regions it is drawn over
+            ForceOpaqueAlpha();
+        EndTextureMode();
+        
+        BeginTextureMode(idleFrame);
+            RedrawIdleRegion((Rectangle){ 0, 0, screenWidth, screenHeight }, blink);
+        EndTextureMode();
+        
+        idleScreen = currentScreen;
+        idleBlink = blink;
+        idleSeaScrolling = seaScrolling;
+        
+        return;
+    }
+    
+    bool seaDamaged = (currentScreen == TITLE) && (seaScrolling != idleSeaScrolling);
+    bool blinkDamaged = (blink != idleBlink);
+    
+    if (!seaDamaged && !blinkDamaged) return;
+    
+    BeginTextureMode(idleFrame);
+    
+        if (seaDamaged) RedrawIdleRegion(idleSeaRegion, blink);
+        
+        if (blinkDamaged)
+        {
+            const char *text = NULL;
+            Vector2 position = { 0 };
+            float spacing = 0;
+            Color color = WHITE;
+            
+            if (GetBlinkText(&text, &position, &spacing, &color))
             {
-                // Draw a transparent black rectangle that covers all screen
-                DrawRectangle(0, 0, screenWidth, screenHeight, Fade(BLACK, 0.4f));
-                if (gameraMode)
-                    DrawTextEx(font, "HENRIC DID 9/11", (Vector2){ 200, 160 }, font.baseSize*3, -2, MAROON);
-                else
-                    DrawTextEx(font, "EAGLE DID 9/11", (Vector2){ 220, 160 }, font.baseSize*3, -2, MAROON);
-                
-                DrawTextEx(font, TextFormat("SCORE: %04i", score), (Vector2){ 680, 350 }, font.baseSize, -2, GOLD);
-                DrawTextEx(font, TextFormat("DISTANCE: %04i", (int)distance), (Vector2){ 290, 350 }, font.baseSize, -2, GOLD);
-                DrawTextEx(font, TextFormat("HISCORE: %04i", hiscore), (Vector2){ 665, 400 }, font.baseSize, -2, ORANGE);
-                DrawTextEx(font, TextFormat("HIDISTANCE: %04i", (int)hidistance), (Vector2){ 270, 400 }, font.baseSize, -2, ORANGE);
-                
-                // Draw blinking text
-                if ((framesCounter/30) % 2) DrawTextEx(font, "PRESS ENTER to REPLAY", (Vector2){ screenWidth/2 - 250, 520 }, font.baseSize, -2, LIGHTGRAY);
-                DrawTextEx(font, "PRESS C to show CREDITS", (Vector2){ screenWidth/2 - 250, 580 }, font.baseSize, -2, GRAY);
-            } break;
-            case CREDITS:
+                // Pad measured size to cover glyphs overhang
+                Vector2 size = MeasureTextEx(font, text, font.baseSize, spacing);
+                RedrawIdleRegion((Rectangle){ position.x - 4, position.y - 4, size.x + 8, size.y + 8 }, blink);
+            }
+        }
+    
+    EndTextureMode();
+    
+    idleBlink = blink;
+    idleSeaScrolling = seaScrolling;
+}
+
+// Accumulate wall, CPU and GPU time of previous frame into its screen stats, report periodically
+void UpdateStats(void)
+{
+    double time = GetTime();
+    clock_t cpuClock = clock();
+    
+    if (statsLastTime > 0.0)
+    {
+        statsWallTime[statsScreen] += time - statsLastTime;
+        statsCpuTime[statsScreen] += (double)(cpuClock - statsLastClock)/CLOCKS_PER_SEC;
+        statsFrames[statsScreen]++;
+        if (idleThrottled) statsThrottledFrames[statsScreen]++;     // Throttle state is updated later in the frame
+    }
+    
+    statsLastTime = time;
+    statsLastClock = cpuClock;
+    
+    ReadGpuTimers(false);
+    
+    if ((currentScreen != statsScreen) || (statsWallTime[statsScreen] >= STATS_REPORT_SECONDS)) ReportStats(statsScreen);
+    
+    statsScreen = currentScreen;
+}
+
+// Print and reset screen stats, utilization is relative to one CPU core / the whole GPU
+void ReportStats(GameScreen screen)
+{
+    static const char *screenNames[] = { "TITLE", "GAMEPLAY", "ENDING", "WIN", "CREDITS" };
+    
+    double wall = statsWallTime[screen];
+    
+    if ((statsFrames[screen] == 0) || (wall <= 0.0)) return;
+    
+    char report[256] = { 0 };
+    int length = snprintf(report, sizeof(report), "%-8s %5.1f fps | cpu %5.1f%% | gpu ", screenNames[screen], statsFrames[screen]/wall, 100.0*statsCpuTime[screen]/wall);
+    
+#if defined(SUPPORT_GPU_TIMING)
+    length += snprintf(report + length, sizeof(report) - length, "%5.1f%%", 100.0*statsGpuTime[screen]/wall);
+#else
+    length += snprintf(report + length, sizeof(report) - length, "  n/a");
+#endif
+    
+    length += snprintf(report + length, sizeof(report) - length, " | redraw %5.1f%%", 100.0*statsRedrawn[screen]/((double)statsFrames[screen]*screenWidth*screenHeight));
+    
+    if (screen == GAMEPLAY) length += snprintf(report + length, sizeof(report) - length, " | enemies drawn %.1f culled %.1f", statsDrawn[screen]/statsFrames[screen], statsCulled[screen]/statsFrames[screen]);
+    if (IsIdleScreen(screen)) length += snprintf(report + length, sizeof(report) - length, " | idle %5.1f%%", 100.0*statsThrottledFrames[screen]/statsFrames[screen]);
+    
+    TraceLog(LOG_INFO, "STATS: %s", report);
+    
+    statsWallTime[screen] = 0.0;
+    statsCpuTime[screen] = 0.0;
+    statsGpuTime[screen] = 0.0;
+    statsRedrawn[screen] = 0.0;
+    statsDrawn[screen] = 0.0;
+    statsCulled[screen] = 0.0;
+    statsFrames[screen] = 0;
+    statsThrottledFrames[screen] = 0;
+}
+
+// Begin GPU timer query for current frame draw commands
+void BeginGpuTimer(void)
+{
+#if defined(SUPPORT_GPU_TIMING)
+    if (!statsMode) return;
+    
+    // Queries ring full, wait for the oldest result
+    if (gpuQueryIssued - gpuQueryRead >= GPU_QUERY_COUNT) ReadGpuTimers(true);
+    
+    gpuQueryScreen[gpuQueryIssued%GPU_QUERY_COUNT] = statsScreen;
+    glBeginQuery(GL_TIME_ELAPSED, gpuQueries[gpuQueryIssued%GPU_QUERY_COUNT]);
+#endif
+}
+
+// End GPU timer query, must be called before EndDrawing() so frame wait is not timed
+void EndGpuTimer(void)
+{
+#if defined(SUPPORT_GPU_TIMING)
+    if (!statsMode) return;
+    
+    rlglDraw();     // Flush batched draw calls into the timed range
+    glEndQuery(GL_TIME_ELAPSED);
+    
+    gpuQueryIssued++;
+#endif
+}
+
+// Collect finished GPU timer queries into screen stats (first one waited if required)
+void ReadGpuTimers(bool wait)
+{
+#if defined(SUPPORT_GPU_TIMING)
+    if (!statsMode) return;
+    
+    while (gpuQueryRead < gpuQueryIssued)
+    {
+        unsigned int query = gpuQueries[gpuQueryRead%GPU_QUERY_COUNT];
+        
+        if (!wait)
+        {
+            int available = 0;
+            glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) break;
+        }
+        
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+        
+        statsGpuTime[gpuQueryScreen[gpuQueryRead%GPU_QUERY_COUNT]] += (double)elapsed/1000000000.0;
+        gpuQueryRead++;
+        wait = false;
+    }
+#else
+    (void)wait;
+#endif
+}
+
+
+// Check key pressed, scripted presses replace live input so runs are reproducible
+bool IsGameKeyPressed(int key)
+{
+#if defined(SUPPORT_IDLE_THROTTLE)
+    if (!scriptMode) return IsKeyPressed(key) || (idleEnabled && idleKeyLatch[key]);
+#else
+    if (!scriptMode) return IsKeyPressed(key);
+#endif
+    
+    for (int i = 0; i < scriptCount; i++)
+    {
+        if ((scriptFrame[i] == (int)frameIndex) && (scriptKey[i] == key)) return true;
+    }
+    
+    return false;
+}
+
+// Load input script: one "<frame> <KEY>" press per line, '#' starts a comment
+// NOTE: Frames are counted from 1 (first UpdateDrawFrame()), captured frame_NNNNN files use the same numbers
+bool LoadInputScript(const char *fileName)
+{
+    FILE *file = fopen(fileName, "rt");
+    
+    if (file == NULL)
+    {
+        TraceLog(LOG_ERROR, "SCRIPT: Input script could not be opened: %s", fileName);
+        return false;
+    }
+    
+    char line[128] = { 0 };
+    char keyName[32] = { 0 };
+    int frame = 0;
+    int lineNumber = 0;
+    
+    scriptCount = 0;
+    
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        lineNumber++;
+        
+        line[strcspn(line, "\r\n")] = '\0';
+        
+        if ((line[0] == '#') || (line[0] == '\0')) continue;
+        
+        if (sscanf(line, "%d %31s", &frame, keyName) != 2) 
+        {
+            TraceLog(LOG_WARNING, "SCRIPT: Line %i ignored: %s", lineNumber, line);
+            continue;
+        }
+        
+        int key = 0;
+        
+        if (strcmp(keyName, "ENTER") == 0) key = KEY_ENTER;
+        else if (strcmp(keyName, "UP") == 0) key = KEY_UP;
+        else if (strcmp(keyName, "DOWN") == 0) key = KEY_DOWN;
+        else if (strcmp(keyName, "C") == 0) key = KEY_C;
+        else if (strcmp(keyName, "T") == 0) key = KEY_T;
+        else
+        {
+            TraceLog(LOG_WARNING, "SCRIPT: Line %i, unknown key: %s", lineNumber, keyName);
+            continue;
+        }
+        
+        if (scriptCount >= MAX_SCRIPT_EVENTS)
+        {
+            TraceLog(LOG_WARNING, "SCRIPT: Truncated at %i events", MAX_SCRIPT_EVENTS);
+            break;
+        }
+        
+        scriptFrame[scriptCount] = frame;
+        scriptKey[scriptCount] = key;
+        scriptCount++;
+    }
+    
+    fclose(file);
+    
+    scriptMode = true;
+    
+    return true;
+}
+
+#if defined(SUPPORT_CAPTURE_MODE)
+// Writer thread: encode queued frames to disk, rows are stored bottom-up (OpenGL readback)
+void *CaptureWriterThread(void *arg)
+{
+    (void)arg;
+    
+    const int stride = screenWidth*4;
+    char fileName[512] = { 0 };
+    
+    while (true)
+    {
+        pthread_mutex_lock(&captureLock);
+        
+        while ((capturePendingCount == 0) && !captureQuit) pthread_cond_wait(&captureCanWrite, &captureLock);
+        
+        if (capturePendingCount == 0)
+        {
+            pthread_mutex_unlock(&captureLock);
+            break;
+        }
+        
+        int slot = capturePending[capturePendingHead];
+        unsigned int frame = capturePendingFrame[capturePendingHead];
+        capturePendingHead = (capturePendingHead + 1)%CAPTURE_POOL_SIZE;
+        capturePendingCount--;
+        
+        pthread_mutex_unlock(&captureLock);
+        
+        unsigned char *pixels = capturePool[slot];
+        
+        snprintf(fileName, sizeof(fileName), "%s/frame_%05u.%s", captureDir, frame, capturePng? "png" : "raw");
+        
+        bool written = false;
+        
+        if (capturePng) 
+        {
+            // NOTE: stbi_flip_vertically_on_write() is enabled on InitCapture()
+            written = stbi_write_png(fileName, screenWidth, screenHeight, 4, pixels, stride);
+        }
+        else
+        {
+            FILE *file = fopen(fileName, "wb");
+            
+            if (file != NULL)
             {
-                DrawTextEx(font, "TEAM:", (Vector2){ screenWidth/2 - 50, 120 }, font.baseSize, -2, ORANGE);
-                DrawTextEx(font, "THIBAULT BARBE", (Vector2){ screenWidth/2 - 150, 200 }, font.baseSize, -2, ORANGE);
-                DrawTextEx(font, "BAPTISTE PAUTONNIER", (Vector2){ screenWidth/2 - 150, 250 }, font.baseSize, -2, ORANGE);
-                DrawTextEx(font, "MATTHIEU PILLEUL", (Vector2){ screenWidth/2 - 150, 300 }, font.baseSize, -2, ORANGE);
-                DrawTextEx(font, "CLEMENT BUTET", (Vector2){ screenWidth/2 - 150, 350 }, font.baseSize, -2, ORANGE);
-                DrawTextEx(font, "ANTOINE BOUSSION", (Vector2){ screenWidth/2 - 150, 400 }, font.baseSize, -2, ORANGE);
-                if ((framesCounter/30) % 2) DrawTextEx(font, "PRESS T to go back to TITLE", (Vector2){ screenWidth/2 - 250, 520 }, font.baseSize, -2, LIGHTGRAY);
-
-            } break;
-            default: break;
+                // Write rows top-down, raw RGBA8 frames can be fed to ffmpeg -f rawvideo directly
+                written = true;
+                for (int y = screenHeight - 1; y >= 0; y--) if (fwrite(pixels + y*stride, 1, stride, file) != (size_t)stride) written = false;
+                if (fclose(file) != 0) written = false;
+            }
         }
+        
+        if (!written) TraceLog(LOG_ERROR, "CAPTURE: Frame could not be written: %s", fileName);
+        
+        pthread_mutex_lock(&captureLock);
+        if (!written) captureErrors++;
+        captureFree[captureFreeCount++] = slot;
+        pthread_cond_signal(&captureCanFill);
+        pthread_mutex_unlock(&captureLock);
+    }
+    
+    return NULL;
+}
 
-    EndDrawing();
-    //----------------------------------------------------------------------------------
+// Create capture render target, PBOs ring and writer threads
+bool InitCapture(void)
+{
+    const int frameSize = screenWidth*screenHeight*4;
+    
+    captureTarget = LoadRenderTexture(screenWidth, screenHeight);
+    
+    glGenBuffers(CAPTURE_PBO_COUNT, capturePbo);
+    
+    for (int i = 0; i < CAPTURE_PBO_COUNT; i++)
+    {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, capturePbo[i]);
+        glBufferData(GL_PIXEL_PACK_BUFFER, frameSize, NULL, GL_STREAM_READ);
+    }
+    
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    
+    for (int i = 0; i < CAPTURE_POOL_SIZE; i++)
+    {
+        capturePool[i] = (unsigned char *)malloc(frameSize);
+        captureFree[i] = i;
+        
+        if (capturePool[i] == NULL)
+        {
+            TraceLog(LOG_ERROR, "CAPTURE: Failed to allocate frame buffers");
+            ReleaseCapture();
+            return false;
+        }
+    }
+    
+    captureFreeCount = CAPTURE_POOL_SIZE;
+    capturePendingHead = 0;
+    capturePendingCount = 0;
+    captureErrors = 0;
+    captureQuit = false;
+    
+    stbi_flip_vertically_on_write(1);
+    
+    for (captureWriterCount = 0; captureWriterCount < CAPTURE_WRITER_THREADS; captureWriterCount++)
+    {
+        if (pthread_create(&captureWriters[captureWriterCount], NULL, CaptureWriterThread, NULL) != 0)
+        {
+            TraceLog(LOG_ERROR, "CAPTURE: Failed to create writer thread");
+            ReleaseCapture();
+            return false;
+        }
+    }
+    
+    captureStartTime = GetTime();
+    
+    return true;
 }
+
+// Stop writer threads (pending frames are written first) and release capture resources
+void ReleaseCapture(void)
+{
+    pthread_mutex_lock(&captureLock);
+    captureQuit = true;
+    pthread_cond_broadcast(&captureCanWrite);
+    pthread_mutex_unlock(&captureLock);
+    
+    for (int i = 0; i < captureWriterCount; i++) pthread_join(captureWriters[i], NULL);
+    captureWriterCount = 0;
+    
+    for (int i = 0; i < CAPTURE_POOL_SIZE; i++)
+    {
+        free(capturePool[i]);
+        capturePool[i] = NULL;
+    }
+    
+    glDeleteBuffers(CAPTURE_PBO_COUNT, capturePbo);
+    UnloadRenderTexture(captureTarget);
+}
+
+// Copy a completed readback out of its PBO and hand it to the writer threads
+void DrainCaptureFrame(void)
+{
+    const int frameSize = screenWidth*screenHeight*4;
+    
+    // Wait for a free frame buffer, writers falling behind throttle rendering instead of dropping frames
+    pthread_mutex_lock(&captureLock);
+    while (captureFreeCount == 0) pthread_cond_wait(&captureCanFill, &captureLock);
+    int slot = captureFree[--captureFreeCount];
+    pthread_mutex_unlock(&captureLock);
+    
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, capturePbo[captureDrained%CAPTURE_PBO_COUNT]);
+    
+    void *data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, frameSize, GL_MAP_READ_BIT);
+    
+    unsigned int frame = capturePboFrame[captureDrained%CAPTURE_PBO_COUNT];
+    
+    if (data != NULL)
+    {
+        memcpy(capturePool[slot], data, frameSize);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    else TraceLog(LOG_ERROR, "CAPTURE: Frame %u readback could not be mapped", frame);
+    
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    
+    pthread_mutex_lock(&captureLock);
+    
+    if (data != NULL)
+    {
+        int tail = (capturePendingHead + capturePendingCount)%CAPTURE_POOL_SIZE;
+        capturePending[tail] = slot;
+        capturePendingFrame[tail] = frame;
+        capturePendingCount++;
+        pthread_cond_signal(&captureCanWrite);
+    }
+    else
+    {
+        captureFree[captureFreeCount++] = slot;
+        captureErrors++;
+    }
+    
+    pthread_mutex_unlock(&captureLock);
+    
+    captureDrained++;
+}
+
+// Queue async readback of capture render target
+// NOTE: glReadPixels() into a PBO returns immediately, data is mapped CAPTURE_PBO_COUNT - 1 frames later
+void CaptureFrame(void)
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, captureTarget.id);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, capturePbo[captureIssued%CAPTURE_PBO_COUNT]);
+    
+    glReadPixels(0, 0, screenWidth, screenHeight, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+    
+    capturePboFrame[captureIssued%CAPTURE_PBO_COUNT] = frameIndex;
+    
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    
+    captureIssued++;
+    
+    if (captureIssued - captureDrained >= CAPTURE_PBO_COUNT) DrainCaptureFrame();
+}
+
+// Flush pending frames and release capture resources, returns false if any frame is missing
+bool CloseCapture(void)
+{
+    while (captureDrained < captureIssued) DrainCaptureFrame();
+    
+    ReleaseCapture();
+    
+    double elapsed = GetTime() - captureStartTime;
+    unsigned int written = captureDrained - captureErrors;
+    
+    TraceLog(LOG_INFO, "CAPTURE: %u frames written to %s in %.2f s (%.1f fps)", written, captureDir, elapsed, (elapsed > 0.0)? written/elapsed : 0.0);
+    
+    if (captureErrors > 0) TraceLog(LOG_ERROR, "CAPTURE: %u frames missing", captureErrors);
+    
+    return (captureErrors == 0);
+}
+#endif